@@ -3,14 +3,20 @@
 #include <Blueprint/UserWidget.h>
 #include <Blueprint/UserWidgetPool.h>
 #include <Containers/Ticker.h>
+#include <Engine/GameInstance.h>
+#include <Engine/LocalPlayer.h>
 #include <Engine/World.h>
 #include <GameFramework/PlayerController.h>
+#include <Misc/Paths.h>
 #include <Misc/ScopeLock.h>
 #include <Stats/Stats.h>
 #include <TimerManager.h>
+#include <UObject/UObjectGlobals.h>
 
 #include "LogAsyncWidgetLoader.h"
+#include "AsyncWidgetRequestGroup.h"
 #include "Interfaces/IAsyncWidgetRequestHandler.h"
+#include "Trace/AsyncWidgetTraceReplayer.h"
 
 UAsyncWidgetLoaderSubsystem::UAsyncWidgetLoaderSubsystem()
 	: NextRequestId(1)
@@ -21,7 +27,8 @@ void UAsyncWidgetLoaderSubsystem::Initialize(FSubsystemCollectionBase& Collectio
 {
 	Super::Initialize(Collection);
 
-	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	// Use the game instance timer manager, it outlives any single world
+	FTimerManager& TimerManager = GetGameInstance()->GetTimerManager();
 	TimerManager.SetTimer(
 		CleanupTimerHandle,
 		this,
@@ -29,10 +36,24 @@ void UAsyncWidgetLoaderSubsystem::Initialize(FSubsystemCollectionBase& Collectio
 		CleanupInterval,
 		true
 	);
+
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddUObject(this, &ThisClass::OnWorldCleanup);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::OnPostLoadMapWithWorld);
 }
 
 void UAsyncWidgetLoaderSubsystem::Deinitialize()
 {
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	StopWaitingForPlayerController();
+	GetGameInstance()->GetTimerManager().ClearTimer(CleanupTimerHandle);
+
+	if (TraceReplayer)
+	{
+		TraceReplayer->StopReplay();
+		TraceReplayer = nullptr;
+	}
+
 	// Cancel all pending requests
 	TArray<int32> RequestIds;
 	ActiveRequests.GetKeys(RequestIds);
@@ -42,6 +63,7 @@ void UAsyncWidgetLoaderSubsystem::Deinitialize()
 	}
 
 	ResetWidgetPools();
+	TravelPersistentClasses.Reset();
 
 	Super::Deinitialize();
 }
@@ -65,7 +87,7 @@ UUserWidget* UAsyncWidgetLoaderSubsystem::RequestWidget_Async(
 		return nullptr;
 	}
 
-	if (!WidgetClass.IsValid())
+	if (WidgetClass.IsNull())
 	{
 		UE_LOG(LogAsyncWidgetLoader, Error, TEXT("%hs: Invalid widget class"), __FUNCTION__);
 		return nullptr;
@@ -77,22 +99,30 @@ UUserWidget* UAsyncWidgetLoaderSubsystem::RequestWidget_Async(
 	if (UClass* LoadedClass = WidgetClass.Get())
 	{
 		// Create the widget immediately
-		return GetOrCreatePooledWidget(LoadedClass);
+		UUserWidget* Widget = AcquirePooledWidget(LoadedClass);
+		TraceRecorder.Record(EAsyncWidgetTraceEventType::ImmediateRequest, OutRequestId, WidgetClass.ToSoftObjectPath(), Priority, TraceRecorder.TrackWidget(Widget));
+		return Widget;
 	}
 
 	// Widget class not already loaded, start async loading
 
 	// Create a new request
-	FAsyncWidgetRequest& Request = ActiveRequests.Add(NextRequestId);
-	Request.RequestId = NextRequestId;
+	FAsyncWidgetRequest& Request = ActiveRequests.Add(OutRequestId);
+	Request.RequestId = OutRequestId;
 	Request.ClassPath = WidgetClass.ToSoftObjectPath();
 	Request.WidgetClass = WidgetClass;
 	Request.Requester = Requester;
+	Request.RequesterKey = Requester;
 	Request.OnLoadCompleted = OnLoadCompleted;
 	Request.Priority = Priority;
 	Request.RequestTime = FPlatformTime::Seconds();
 	Request.Status = EAsyncWidgetLoadStatus::Loading;
 
+	RequesterToRequestIds.FindOrAdd(Request.RequesterKey).Add(OutRequestId);
+
+	Stats.PeakInFlightRequests = FMath::Max(Stats.PeakInFlightRequests, ActiveRequests.Num());
+	TraceRecorder.Record(EAsyncWidgetTraceEventType::Request, OutRequestId, Request.ClassPath, Priority);
+
 	// Notify via interface if implemented
 	if (Requester->Implements<UAsyncWidgetRequestHandler>())
 	{
@@ -104,6 +134,21 @@ UUserWidget* UAsyncWidgetLoaderSubsystem::RequestWidget_Async(
 		Request.ClassPath,
 		[this, RequestId = OutRequestId]()
 		{
+			if (SyntheticLoadDelay > 0.0f)
+			{
+				FTSTicker::GetCoreTicker().AddTicker(
+					FTickerDelegate::CreateWeakLambda(this, [this, RequestId](float)
+					{
+						// The request may have been cancelled while the completion was held back
+						if (ActiveRequests.Contains(RequestId))
+						{
+							OnWidgetClassLoaded(RequestId);
+						}
+						return false;
+					}),
+					SyntheticLoadDelay);
+				return;
+			}
 			OnWidgetClassLoaded(RequestId);
 		},
 		Priority);
@@ -134,6 +179,8 @@ bool UAsyncWidgetLoaderSubsystem::CancelRequest(const int32 RequestId)
 		return false;
 	}
 
+	TraceRecorder.Record(EAsyncWidgetTraceEventType::Cancel, RequestId, Request->ClassPath, Request->Priority);
+
 	// Cancel the streamable handle
 	Request->Cancel();
 
@@ -150,11 +197,33 @@ bool UAsyncWidgetLoaderSubsystem::CancelRequest(const int32 RequestId)
 	}
 
 	// Remove from active requests
-	ActiveRequests.Remove(RequestId);
+	RemoveRequest(RequestId);
 
 	return true;
 }
 
+int32 UAsyncWidgetLoaderSubsystem::CancelAllForRequester(UObject* Requester)
+{
+	const TArray<int32>* RequestIds = Requester ? RequesterToRequestIds.Find(Requester) : nullptr;
+	if (!RequestIds)
+	{
+		return 0;
+	}
+
+	// CancelRequest removes entries from the index, so work on a copy
+	const TArray<int32> RequestIdsToCancel = *RequestIds;
+	int32 NumCancelled = 0;
+	for (const int32 RequestId : RequestIdsToCancel)
+	{
+		if (CancelRequest(RequestId))
+		{
+			++NumCancelled;
+		}
+	}
+
+	return NumCancelled;
+}
+
 EAsyncWidgetLoadStatus UAsyncWidgetLoaderSubsystem::GetRequestStatus(const int32 RequestId) const
 {
 	const FAsyncWidgetRequest* Request = ActiveRequests.Find(RequestId);
@@ -185,6 +254,29 @@ void UAsyncWidgetLoaderSubsystem::SetWidgetCreationContext(UWorld* World, APlaye
 	}
 }
 
+void UAsyncWidgetLoaderSubsystem::SetWidgetClassTravelPersistent(const TSoftClassPtr<UUserWidget>& WidgetClass, const bool bPersistent)
+{
+	if (WidgetClass.IsNull())
+	{
+		UE_LOG(LogAsyncWidgetLoader, Error, TEXT("%hs: Invalid widget class"), __FUNCTION__);
+		return;
+	}
+
+	if (bPersistent)
+	{
+		TravelPersistentClasses.FindOrAdd(WidgetClass.ToString()) = WidgetClass.Get();
+	}
+	else
+	{
+		TravelPersistentClasses.Remove(WidgetClass.ToString());
+	}
+}
+
+bool UAsyncWidgetLoaderSubsystem::IsWidgetClassTravelPersistent(const TSoftClassPtr<UUserWidget>& WidgetClass) const
+{
+	return TravelPersistentClasses.Contains(WidgetClass.ToString());
+}
+
 void UAsyncWidgetLoaderSubsystem::ResetWidgetPools()
 {
 	// Clear all pools
@@ -192,9 +284,20 @@ void UAsyncWidgetLoaderSubsystem::ResetWidgetPools()
 	{
 		Pair.Value.ResetPool();
 	}
+	KnownPooledWidgets.Reset();
 }
 
 UUserWidget* UAsyncWidgetLoaderSubsystem::GetOrCreatePooledWidget(const TSubclassOf<UUserWidget>& LoadedWidgetClass)
+{
+	UUserWidget* Widget = AcquirePooledWidget(LoadedWidgetClass);
+	if (Widget)
+	{
+		TraceRecorder.Record(EAsyncWidgetTraceEventType::Acquire, INDEX_NONE, FSoftObjectPath(LoadedWidgetClass.Get()), 0.0f, TraceRecorder.TrackWidget(Widget));
+	}
+	return Widget;
+}
+
+UUserWidget* UAsyncWidgetLoaderSubsystem::AcquirePooledWidget(const TSubclassOf<UUserWidget>& LoadedWidgetClass)
 {
 	if (!LoadedWidgetClass)
 	{
@@ -202,8 +305,30 @@ UUserWidget* UAsyncWidgetLoaderSubsystem::GetOrCreatePooledWidget(const TSubclas
 		return nullptr;
 	}
 
+	const TSoftClassPtr<UUserWidget> ClassPath(LoadedWidgetClass.Get());
+
+	// Keep persistent classes referenced so they stay loaded across map travel
+	if (TObjectPtr<UClass>* PersistentClass = TravelPersistentClasses.Find(ClassPath.ToString()))
+	{
+		*PersistentClass = LoadedWidgetClass.Get();
+	}
+
 	// Get a widget from the pool
-	return GetOrCreatePool(LoadedWidgetClass.Get()).GetOrCreateInstance(LoadedWidgetClass);
+	UUserWidget* Widget = GetOrCreatePool(ClassPath).GetOrCreateInstance(LoadedWidgetClass);
+	if (Widget)
+	{
+		bool bAlreadyKnown = false;
+		KnownPooledWidgets.Add(Widget, &bAlreadyKnown);
+		if (bAlreadyKnown)
+		{
+			++Stats.PoolHits;
+		}
+		else
+		{
+			++Stats.PoolMisses;
+		}
+	}
+	return Widget;
 }
 
 void UAsyncWidgetLoaderSubsystem::ReleaseWidgetToPool(UUserWidget* Widget)
@@ -215,8 +340,20 @@ void UAsyncWidgetLoaderSubsystem::ReleaseWidgetToPool(UUserWidget* Widget)
 	}
 
 	const FSoftClassPath ClassPath = Widget->GetClass()->GetPathName();
+
+	// Pooled widgets keep their Slate widget when released, so NativeDestruct won't fire for them
+	CancelRequestsOwnedByWidget(Widget);
+
 	if (FUserWidgetPool* Pool = ClassPathToPoolMap.Find(ClassPath.ToString()))
 	{
+		TraceRecorder.Record(EAsyncWidgetTraceEventType::Release, INDEX_NONE, ClassPath, 0.0f, TraceRecorder.UntrackWidget(Widget));
+
+		// A persistent widget that was on screen during travel may still point at the old, dead player controller
+		if (DefaultPlayerController.IsValid() && !Widget->GetOwningPlayer())
+		{
+			Widget->SetPlayerContext(FLocalPlayerContext(DefaultPlayerController.Get()));
+		}
+
 		Pool->Release(Widget);
 	}
 	else
@@ -241,7 +378,8 @@ void UAsyncWidgetLoaderSubsystem::OnWidgetClassLoaded(const int32 RequestId)
 	if (!Request->IsRequesterValid())
 	{
 		UE_LOG(LogAsyncWidgetLoader, Warning, TEXT("%hs: Requester for request %d is no longer valid"), __FUNCTION__, RequestId);
-		ActiveRequests.Remove(RequestId);
+		TraceRecorder.Record(EAsyncWidgetTraceEventType::Dropped, RequestId, Request->ClassPath, Request->Priority);
+		RemoveRequest(RequestId);
 		return;
 	}
 
@@ -251,6 +389,7 @@ void UAsyncWidgetLoaderSubsystem::OnWidgetClassLoaded(const int32 RequestId)
 	{
 		UE_LOG(LogAsyncWidgetLoader, Error, TEXT("%hs: Failed to load class for request %d"), __FUNCTION__, RequestId);
 		Request->Status = EAsyncWidgetLoadStatus::Failed;
+		TraceRecorder.Record(EAsyncWidgetTraceEventType::LoadFailed, RequestId, Request->ClassPath, Request->Priority);
 
 		// Notify failure
 		if (Request->Requester->Implements<UAsyncWidgetRequestHandler>())
@@ -258,16 +397,17 @@ void UAsyncWidgetLoaderSubsystem::OnWidgetClassLoaded(const int32 RequestId)
 			IAsyncWidgetRequestHandler::Execute_OnAsyncWidgetLoadFailed(Request->Requester.Get(), RequestId, Request->WidgetClass);
 		}
 
-		ActiveRequests.Remove(RequestId);
+		RemoveRequest(RequestId);
 		return;
 	}
 
 	// Create the widget
-	UUserWidget* Widget = GetOrCreatePooledWidget(LoadedClass);
+	UUserWidget* Widget = AcquirePooledWidget(LoadedClass);
 	if (!Widget)
 	{
 		UE_LOG(LogAsyncWidgetLoader, Error, TEXT("%hs: Failed to create widget for request %d"), __FUNCTION__, RequestId);
 		Request->Status = EAsyncWidgetLoadStatus::Failed;
+		TraceRecorder.Record(EAsyncWidgetTraceEventType::LoadFailed, RequestId, Request->ClassPath, Request->Priority);
 
 		// Notify failure
 		if (Request->Requester->Implements<UAsyncWidgetRequestHandler>())
@@ -275,10 +415,12 @@ void UAsyncWidgetLoaderSubsystem::OnWidgetClassLoaded(const int32 RequestId)
 			IAsyncWidgetRequestHandler::Execute_OnAsyncWidgetLoadFailed(Request->Requester.Get(), RequestId, Request->WidgetClass);
 		}
 
-		ActiveRequests.Remove(RequestId);
+		RemoveRequest(RequestId);
 		return;
 	}
 
+	TraceRecorder.Record(EAsyncWidgetTraceEventType::LoadCompleted, RequestId, Request->ClassPath, Request->Priority, TraceRecorder.TrackWidget(Widget));
+
 	// Call the completion callback
 	if (Request->OnLoadCompleted.IsBound())
 	{
@@ -296,7 +438,7 @@ void UAsyncWidgetLoaderSubsystem::OnWidgetClassLoaded(const int32 RequestId)
 	}
 
 	// Remove from active requests
-	ActiveRequests.Remove(RequestId);
+	RemoveRequest(RequestId);
 }
 
 void UAsyncWidgetLoaderSubsystem::CleanupRequests()
@@ -342,6 +484,8 @@ void UAsyncWidgetLoaderSubsystem::CleanupRequests()
 	{
 		if (FAsyncWidgetRequest* Request = ActiveRequests.Find(RequestId))
 		{
+			TraceRecorder.Record(EAsyncWidgetTraceEventType::Dropped, RequestId, Request->ClassPath, Request->Priority);
+
 			// Cancel the request
 			Request->Cancel();
 
@@ -351,11 +495,109 @@ void UAsyncWidgetLoaderSubsystem::CleanupRequests()
 				Request->PlaceholderWidget.Reset();
 			}
 
-			ActiveRequests.Remove(RequestId);
+			RemoveRequest(RequestId);
+		}
+	}
+}
+
+void UAsyncWidgetLoaderSubsystem::StartTraceRecording()
+{
+	TraceRecorder.Start();
+	UE_LOG(LogAsyncWidgetLoader, Log, TEXT("%hs: Trace recording started"), __FUNCTION__);
+}
+
+bool UAsyncWidgetLoaderSubsystem::StopTraceRecording(const FString& FilePath)
+{
+	if (!TraceRecorder.IsRecording())
+	{
+		UE_LOG(LogAsyncWidgetLoader, Warning, TEXT("%hs: No trace recording in progress"), __FUNCTION__);
+		return false;
+	}
+
+	TraceRecorder.Stop();
+	return TraceRecorder.GetTrace().SaveToFile(FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir(), FilePath));
+}
+
+bool UAsyncWidgetLoaderSubsystem::ReplayTrace(const FString& FilePath, const float InSyntheticLoadDelay)
+{
+	if (TraceReplayer && TraceReplayer->IsReplaying())
+	{
+		UE_LOG(LogAsyncWidgetLoader, Warning, TEXT("%hs: A replay is already in progress"), __FUNCTION__);
+		return false;
+	}
+
+	FAsyncWidgetTrace Trace;
+	if (!Trace.LoadFromFile(FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir(), FilePath)))
+	{
+		return false;
+	}
+
+	TraceReplayer = NewObject<UAsyncWidgetTraceReplayer>(this);
+	TraceReplayer->StartReplay(this, MoveTemp(Trace), InSyntheticLoadDelay);
+	return true;
+}
+
+void UAsyncWidgetLoaderSubsystem::ResetStats()
+{
+	Stats = FAsyncWidgetLoaderStats();
+}
+
+void UAsyncWidgetLoaderSubsystem::CancelRequestsOwnedByWidget(UUserWidget* Widget)
+{
+	CancelAllForRequester(Widget);
+
+	if (const TArray<FAsyncWidgetRequestGroup*>* Groups = WidgetToRequestGroups.Find(Widget))
+	{
+		// Cancel callbacks may destroy groups, so only touch those that are still registered
+		const TArray<FAsyncWidgetRequestGroup*> GroupsToCancel = *Groups;
+		for (FAsyncWidgetRequestGroup* Group : GroupsToCancel)
+		{
+			const TArray<FAsyncWidgetRequestGroup*>* RegisteredGroups = WidgetToRequestGroups.Find(Widget);
+			if (RegisteredGroups && RegisteredGroups->Contains(Group))
+			{
+				Group->CancelAll();
+			}
 		}
 	}
 }
 
+void UAsyncWidgetLoaderSubsystem::RegisterRequestGroup(UUserWidget* OwningWidget, FAsyncWidgetRequestGroup* Group)
+{
+	WidgetToRequestGroups.FindOrAdd(OwningWidget).AddUnique(Group);
+}
+
+void UAsyncWidgetLoaderSubsystem::UnregisterRequestGroup(const TObjectKey<UUserWidget>& OwningWidget, FAsyncWidgetRequestGroup* Group)
+{
+	if (TArray<FAsyncWidgetRequestGroup*>* Groups = WidgetToRequestGroups.Find(OwningWidget))
+	{
+		Groups->RemoveSingleSwap(Group);
+		if (Groups->IsEmpty())
+		{
+			WidgetToRequestGroups.Remove(OwningWidget);
+		}
+	}
+}
+
+void UAsyncWidgetLoaderSubsystem::RemoveRequest(const int32 RequestId)
+{
+	const FAsyncWidgetRequest* Request = ActiveRequests.Find(RequestId);
+	if (!Request)
+	{
+		return;
+	}
+
+	if (TArray<int32>* RequestIds = RequesterToRequestIds.Find(Request->RequesterKey))
+	{
+		RequestIds->RemoveSingleSwap(RequestId);
+		if (RequestIds->IsEmpty())
+		{
+			RequesterToRequestIds.Remove(Request->RequesterKey);
+		}
+	}
+
+	ActiveRequests.Remove(RequestId);
+}
+
 FUserWidgetPool& UAsyncWidgetLoaderSubsystem::GetOrCreatePool(const TSoftClassPtr<UUserWidget>& ClassPath)
 {
 	const FString PathString = ClassPath.ToString();
@@ -366,11 +608,148 @@ FUserWidgetPool& UAsyncWidgetLoaderSubsystem::GetOrCreatePool(const TSoftClassPt
 
 	// Create a new pool
 	FUserWidgetPool& NewPool = ClassPathToPoolMap.Add(PathString);
-	if (DefaultWorld.IsValid() && DefaultPlayerController.IsValid())
+	if (DefaultWorld.IsValid())
 	{
 		NewPool.SetWorld(DefaultWorld.Get());
+	}
+	if (DefaultPlayerController.IsValid())
+	{
 		NewPool.SetDefaultPlayerController(DefaultPlayerController.Get());
 	}
 
 	return NewPool;
-}
\ No newline at end of file
+}
+
+void UAsyncWidgetLoaderSubsystem::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	if (!World || World->GetGameInstance() != GetGameInstance())
+	{
+		return;
+	}
+
+	if (World == PlayerControllerWaitWorld.Get())
+	{
+		StopWaitingForPlayerController();
+	}
+
+	UGameInstance* GameInstance = GetGameInstance();
+	for (auto It = ClassPathToPoolMap.CreateIterator(); It; ++It)
+	{
+		if (!TravelPersistentClasses.Contains(It.Key()))
+		{
+			It.Value().ResetPool();
+			It.RemoveCurrent();
+			continue;
+		}
+
+		// Widgets outered to the world or its player controller would keep them alive through the pool,
+		// move all of them to the game instance, including ones still on screen
+		TArray<UUserWidget*> Widgets;
+		GetKnownPooledWidgets(It.Key(), Widgets);
+		for (UUserWidget* Widget : Widgets)
+		{
+			if (Widget->IsIn(World))
+			{
+				Widget->Rename(nullptr, GameInstance, REN_DontCreateRedirectors | REN_NonTransactional | REN_DoNotDirty | REN_ForceNoResetLoaders);
+			}
+		}
+	}
+
+	// Known widgets from dropped pools are gone now
+	for (auto It = KnownPooledWidgets.CreateIterator(); It; ++It)
+	{
+		const UUserWidget* Widget = It->ResolveObjectPtr();
+		if (!Widget || !TravelPersistentClasses.Contains(TSoftClassPtr<UUserWidget>(Widget->GetClass()).ToString()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	DefaultPlayerController.Reset();
+
+	UE_LOG(LogAsyncWidgetLoader, Verbose, TEXT("%hs: Kept %d persistent pools for world %s"), __FUNCTION__, ClassPathToPoolMap.Num(), *World->GetName());
+}
+
+void UAsyncWidgetLoaderSubsystem::OnPostLoadMapWithWorld(UWorld* World)
+{
+	if (!World || World->GetGameInstance() != GetGameInstance())
+	{
+		return;
+	}
+
+	StopWaitingForPlayerController();
+
+	if (TryApplyTravelContext(World))
+	{
+		return;
+	}
+
+	// On network clients the player controller is spawned after the map has loaded and only gets its
+	// local player later still, point the pools at the new world now and wait for a usable controller
+	DefaultWorld = World;
+	DefaultPlayerController.Reset();
+	for (auto& Pair : ClassPathToPoolMap)
+	{
+		Pair.Value.SetWorld(World);
+	}
+
+	PlayerControllerWaitWorld = World;
+	PlayerControllerWaitHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this](float)
+	{
+		UWorld* WaitWorld = PlayerControllerWaitWorld.Get();
+		if (!WaitWorld || TryApplyTravelContext(WaitWorld))
+		{
+			PlayerControllerWaitWorld.Reset();
+			PlayerControllerWaitHandle.Reset();
+			return false;
+		}
+		return true;
+	}));
+}
+
+bool UAsyncWidgetLoaderSubsystem::TryApplyTravelContext(UWorld* World)
+{
+	// Widgets can only be created for a player controller that has its local player attached
+	APlayerController* PlayerController = GetGameInstance()->GetFirstLocalPlayerController(World);
+	if (!PlayerController || !PlayerController->GetLocalPlayer())
+	{
+		return false;
+	}
+
+	SetWidgetCreationContext(World, PlayerController);
+
+	// On-screen widgets are re-contexted too, they are removed from the old viewport on travel anyway
+	for (const auto& Pair : ClassPathToPoolMap)
+	{
+		TArray<UUserWidget*> Widgets;
+		GetKnownPooledWidgets(Pair.Key, Widgets);
+		for (UUserWidget* Widget : Widgets)
+		{
+			Widget->SetPlayerContext(FLocalPlayerContext(PlayerController));
+		}
+	}
+
+	return true;
+}
+
+void UAsyncWidgetLoaderSubsystem::StopWaitingForPlayerController()
+{
+	if (PlayerControllerWaitHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PlayerControllerWaitHandle);
+		PlayerControllerWaitHandle.Reset();
+	}
+	PlayerControllerWaitWorld.Reset();
+}
+
+void UAsyncWidgetLoaderSubsystem::GetKnownPooledWidgets(const FString& PoolKey, TArray<UUserWidget*>& OutWidgets) const
+{
+	for (const TObjectKey<UUserWidget>& Key : KnownPooledWidgets)
+	{
+		UUserWidget* Widget = Key.ResolveObjectPtr();
+		if (Widget && TSoftClassPtr<UUserWidget>(Widget->GetClass()).ToString() == PoolKey)
+		{
+			OutWidgets.Add(Widget);
+		}
+	}
+}
@@ -0,0 +1,86 @@
+﻿// Copyright Mike Desrosiers 2025, All Rights Reserved.
+
+#include "AsyncWidgetRequestGroup.h"
+
+#include <Blueprint/UserWidget.h>
+
+#include "AsyncWidgetLoaderSubsystem.h"
+
+FAsyncWidgetRequestGroup::FAsyncWidgetRequestGroup(UAsyncWidgetLoaderSubsystem* InSubsystem, UUserWidget* InOwningWidget)
+	: Subsystem(InSubsystem)
+	, OwningWidget(InOwningWidget)
+	, OwningWidgetKey(InOwningWidget)
+{
+	if (InOwningWidget)
+	{
+		if (InSubsystem)
+		{
+			InSubsystem->RegisterRequestGroup(InOwningWidget, this);
+		}
+		OwningWidgetDestructHandle = InOwningWidget->OnNativeDestruct.AddRaw(this, &FAsyncWidgetRequestGroup::OnOwningWidgetDestructed);
+	}
+}
+
+FAsyncWidgetRequestGroup::~FAsyncWidgetRequestGroup()
+{
+	// The widget may already be marked as garbage while its Slate widget, and our binding, are still alive
+	if (UUserWidget* Widget = OwningWidget.Get(/*bEvenIfPendingKill*/ true))
+	{
+		Widget->OnNativeDestruct.Remove(OwningWidgetDestructHandle);
+	}
+
+	if (UAsyncWidgetLoaderSubsystem* LoaderSubsystem = Subsystem.Get())
+	{
+		LoaderSubsystem->UnregisterRequestGroup(OwningWidgetKey, this);
+	}
+
+	CancelAll();
+}
+
+void FAsyncWidgetRequestGroup::Add(const int32 RequestId)
+{
+	PruneFinishedRequests();
+	RequestIds.AddUnique(RequestId);
+}
+
+int32 FAsyncWidgetRequestGroup::CancelAll()
+{
+	// Cancel callbacks may add to or destroy this group, so don't touch members once they start
+	const TArray<int32> RequestIdsToCancel = MoveTemp(RequestIds);
+	RequestIds.Reset();
+
+	int32 NumCancelled = 0;
+	if (UAsyncWidgetLoaderSubsystem* LoaderSubsystem = Subsystem.Get())
+	{
+		for (const int32 RequestId : RequestIdsToCancel)
+		{
+			if (LoaderSubsystem->GetRequestStatus(RequestId) == EAsyncWidgetLoadStatus::Loading &&
+				LoaderSubsystem->CancelRequest(RequestId))
+			{
+				++NumCancelled;
+			}
+		}
+	}
+
+	return NumCancelled;
+}
+
+void FAsyncWidgetRequestGroup::PruneFinishedRequests()
+{
+	const UAsyncWidgetLoaderSubsystem* LoaderSubsystem = Subsystem.Get();
+	if (!LoaderSubsystem)
+	{
+		RequestIds.Reset();
+		return;
+	}
+
+	RequestIds.RemoveAllSwap([LoaderSubsystem](const int32 RequestId)
+	{
+		return LoaderSubsystem->GetRequestStatus(RequestId) != EAsyncWidgetLoadStatus::Loading;
+	});
+}
+
+void FAsyncWidgetRequestGroup::OnOwningWidgetDestructed(UUserWidget* Widget)
+{
+	CancelAll();
+}
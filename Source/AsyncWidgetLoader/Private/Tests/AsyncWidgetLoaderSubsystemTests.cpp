@@ -0,0 +1,100 @@
+﻿// Copyright Mike Desrosiers 2025, All Rights Reserved.
+
+#include <Misc/AutomationTest.h>
+#include <UObject/Package.h>
+
+#include "AsyncWidgetLoaderSubsystem.h"
+#include "AsyncWidgetRequestGroup.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAsyncWidgetRequesterIndexTest, "AsyncWidgetLoader.Subsystem.RequesterIndex",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAsyncWidgetRequesterIndexTest::RunTest(const FString& Parameters)
+{
+	UAsyncWidgetLoaderSubsystem* Subsystem = NewObject<UAsyncWidgetLoaderSubsystem>(GetTransientPackage());
+	UObject* RequesterA = NewObject<UObject>(GetTransientPackage());
+	UObject* RequesterB = NewObject<UObject>(GetTransientPackage());
+	UObject* RequesterC = NewObject<UObject>(GetTransientPackage());
+
+	// Classes that are never loaded, so requests stay in flight until we end them
+	auto Request = [Subsystem](UObject* Requester, int32 Index)
+	{
+		int32 RequestId = INDEX_NONE;
+		const TSoftClassPtr<UUserWidget> WidgetClass(FSoftObjectPath(FString::Printf(TEXT("/Game/AsyncWidgetLoaderTests/WBP_Missing%d.WBP_Missing%d_C"), Index, Index)));
+		Subsystem->RequestWidget_Async(WidgetClass, Requester, RequestId, FOnAsyncWidgetLoadedDynamic());
+		return RequestId;
+	};
+
+	auto NumIndexed = [Subsystem](UObject* Requester)
+	{
+		const TArray<int32>* RequestIds = Subsystem->RequesterToRequestIds.Find(Requester);
+		return RequestIds ? RequestIds->Num() : 0;
+	};
+
+	TestEqual(TEXT("Null requester cancels nothing"), Subsystem->CancelAllForRequester(nullptr), 0);
+	TestEqual(TEXT("Unknown requester cancels nothing"), Subsystem->CancelAllForRequester(RequesterA), 0);
+
+	const int32 RequestA1 = Request(RequesterA, 1);
+	Request(RequesterA, 2);
+	Request(RequesterB, 3);
+	TestEqual(TEXT("Requests in flight"), Subsystem->GetNumActiveRequests(), 3);
+	TestEqual(TEXT("Requesters indexed"), Subsystem->RequesterToRequestIds.Num(), 2);
+	TestEqual(TEXT("Requests indexed for A"), NumIndexed(RequesterA), 2);
+
+	// Single cancel
+	Subsystem->CancelRequest(RequestA1);
+	TestEqual(TEXT("Cancel removes the request from the index"), NumIndexed(RequesterA), 1);
+
+	// Bulk cancel
+	TestEqual(TEXT("Bulk cancel for A"), Subsystem->CancelAllForRequester(RequesterA), 1);
+	TestFalse(TEXT("A is no longer indexed"), Subsystem->RequesterToRequestIds.Contains(RequesterA));
+	TestEqual(TEXT("Only B's request is left"), Subsystem->GetNumActiveRequests(), 1);
+
+	// Failed completion, the handle is cancelled first so it never calls back on its own
+	const int32 RequestB2 = Request(RequesterB, 4);
+	Subsystem->ActiveRequests[RequestB2].StreamableHandle->CancelHandle();
+	AddExpectedError(TEXT("Failed to load class for request"), EAutomationExpectedErrorFlags::Contains, 1);
+	Subsystem->OnWidgetClassLoaded(RequestB2);
+	TestEqual(TEXT("Failed completion removes the request from the index"), NumIndexed(RequesterB), 1);
+
+	// Completion for a requester that died in the meantime
+	const int32 RequestC1 = Request(RequesterC, 5);
+	Subsystem->ActiveRequests[RequestC1].StreamableHandle->CancelHandle();
+	RequesterC->MarkAsGarbage();
+	Subsystem->OnWidgetClassLoaded(RequestC1);
+	TestEqual(TEXT("Dropped completion removes the request from the index"), Subsystem->RequesterToRequestIds.Num(), 1);
+
+	// CleanupRequests for a requester that died with a load pending
+	Request(RequesterA, 6);
+	Request(RequesterA, 7);
+	RequesterA->MarkAsGarbage();
+	Subsystem->CleanupRequests();
+	TestEqual(TEXT("Cleanup removes dead requesters from the index"), Subsystem->RequesterToRequestIds.Num(), 1);
+	TestEqual(TEXT("Cleanup removes dead requesters' requests"), Subsystem->GetNumActiveRequests(), 1);
+
+	// Request groups cancel what is still in flight when they go out of scope
+	{
+		FAsyncWidgetRequestGroup Group(Subsystem);
+		Group.Add(Request(RequesterB, 8));
+		Group.Add(Request(RequesterB, 9));
+		TestEqual(TEXT("Group requests in flight"), Subsystem->GetNumActiveRequests(), 3);
+	}
+	TestEqual(TEXT("Group cancels its requests on destruction"), Subsystem->GetNumActiveRequests(), 1);
+
+	{
+		FAsyncWidgetRequestGroup Group(Subsystem);
+		Group.Add(Request(RequesterB, 10));
+		TestEqual(TEXT("Explicit group cancel"), Group.CancelAll(), 1);
+		TestEqual(TEXT("Cancelled group is empty"), Group.Num(), 0);
+	}
+
+	TestEqual(TEXT("Bulk cancel for B"), Subsystem->CancelAllForRequester(RequesterB), 1);
+	TestEqual(TEXT("Index is empty"), Subsystem->RequesterToRequestIds.Num(), 0);
+	TestEqual(TEXT("No requests in flight"), Subsystem->GetNumActiveRequests(), 0);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,198 @@
+﻿// Copyright Mike Desrosiers 2025, All Rights Reserved.
+
+#include <HAL/FileManager.h>
+#include <Misc/AutomationTest.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+#include <Serialization/MemoryWriter.h>
+
+#include "AsyncWidgetLoaderSubsystem.h"
+#include "Trace/AsyncWidgetTrace.h"
+#include "Trace/AsyncWidgetTraceReplayer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAsyncWidgetTraceRoundTripTest, "AsyncWidgetLoader.Trace.RoundTrip",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAsyncWidgetTraceRoundTripTest::RunTest(const FString& Parameters)
+{
+	const FSoftObjectPath MenuPath(TEXT("/Game/UI/WBP_Menu.WBP_Menu_C"));
+	const FSoftObjectPath HudPath(TEXT("/Game/UI/WBP_Hud.WBP_Hud_C"));
+
+	FAsyncWidgetTraceRecorder Recorder;
+	Recorder.Start();
+	Recorder.Record(EAsyncWidgetTraceEventType::Request, 1, MenuPath, 2.0f);
+	Recorder.Record(EAsyncWidgetTraceEventType::ImmediateRequest, 2, HudPath, 0.0f, 0);
+	Recorder.Record(EAsyncWidgetTraceEventType::Cancel, 1, MenuPath, 2.0f);
+	Recorder.Record(EAsyncWidgetTraceEventType::Release, INDEX_NONE, HudPath, 0.0f, 0);
+	Recorder.Record(EAsyncWidgetTraceEventType::Request, 3, MenuPath);
+	Recorder.Record(EAsyncWidgetTraceEventType::Dropped, 3, MenuPath);
+	Recorder.Record(EAsyncWidgetTraceEventType::Acquire, INDEX_NONE, HudPath, 0.0f, 1);
+	Recorder.Stop();
+
+	// Events after Stop are ignored
+	Recorder.Record(EAsyncWidgetTraceEventType::Request, 4, MenuPath);
+
+	const FAsyncWidgetTrace& Recorded = Recorder.GetTrace();
+	TestEqual(TEXT("Recorded events"), Recorded.Events.Num(), 7);
+	TestEqual(TEXT("Class paths are stored once"), Recorded.ClassPaths.Num(), 2);
+
+	const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AsyncWidgetTraceRoundTrip.trace"));
+	TestTrue(TEXT("Trace saved"), Recorded.SaveToFile(FilePath));
+
+	FAsyncWidgetTrace Loaded;
+	TestTrue(TEXT("Trace loaded"), Loaded.LoadFromFile(FilePath));
+	TestEqual(TEXT("Loaded class paths"), Loaded.ClassPaths.Num(), Recorded.ClassPaths.Num());
+	if (TestEqual(TEXT("Loaded events"), Loaded.Events.Num(), Recorded.Events.Num()))
+	{
+		for (int32 Index = 0; Index < Loaded.Events.Num(); ++Index)
+		{
+			const FAsyncWidgetTraceEvent& Expected = Recorded.Events[Index];
+			const FAsyncWidgetTraceEvent& Actual = Loaded.Events[Index];
+			TestTrue(FString::Printf(TEXT("Event %d type"), Index), Actual.Type == Expected.Type);
+			TestEqual(FString::Printf(TEXT("Event %d request"), Index), Actual.RequestId, Expected.RequestId);
+			TestEqual(FString::Printf(TEXT("Event %d widget"), Index), Actual.WidgetId, Expected.WidgetId);
+			TestEqual(FString::Printf(TEXT("Event %d timestamp"), Index), Actual.Timestamp, Expected.Timestamp);
+			TestEqual(FString::Printf(TEXT("Event %d priority"), Index), Actual.Priority, Expected.Priority);
+			TestTrue(FString::Printf(TEXT("Event %d class"), Index), Loaded.GetClassPath(Actual) == Recorded.GetClassPath(Expected));
+		}
+	}
+
+	IFileManager::Get().Delete(*FilePath);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAsyncWidgetTraceRejectInvalidTest, "AsyncWidgetLoader.Trace.RejectInvalid",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAsyncWidgetTraceRejectInvalidTest::RunTest(const FString& Parameters)
+{
+	const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AsyncWidgetTraceInvalid.trace"));
+
+	auto WriteHeader = [&FilePath](uint32 Magic, uint32 Version)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		Writer << Magic;
+		Writer << Version;
+		return FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+	};
+
+	AddExpectedError(TEXT("is not a valid trace file"), EAutomationExpectedErrorFlags::Contains, 2);
+
+	FAsyncWidgetTrace Trace;
+	TestTrue(TEXT("Bad magic written"), WriteHeader(0xDEADBEEF, 1));
+	TestFalse(TEXT("Bad magic rejected"), Trace.LoadFromFile(FilePath));
+
+	// 'AWLT' with a version from the future
+	TestTrue(TEXT("Bad version written"), WriteHeader(0x41574C54, 999));
+	TestFalse(TEXT("Bad version rejected"), Trace.LoadFromFile(FilePath));
+	TestEqual(TEXT("Rejected trace is empty"), Trace.Events.Num(), 0);
+
+	IFileManager::Get().Delete(*FilePath);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAsyncWidgetTracePeakInFlightTest, "AsyncWidgetLoader.Trace.PeakInFlight",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAsyncWidgetTracePeakInFlightTest::RunTest(const FString& Parameters)
+{
+	auto MakeTrace = [](std::initializer_list<TPair<EAsyncWidgetTraceEventType, int32>> Events)
+	{
+		FAsyncWidgetTrace Trace;
+		for (const TPair<EAsyncWidgetTraceEventType, int32>& Pair : Events)
+		{
+			FAsyncWidgetTraceEvent& Event = Trace.Events.AddDefaulted_GetRef();
+			Event.Type = Pair.Key;
+			Event.RequestId = Pair.Value;
+		}
+		return Trace;
+	};
+
+	using EType = EAsyncWidgetTraceEventType;
+
+	TestEqual(TEXT("Empty trace"), MakeTrace({}).ComputePeakInFlight(), 0);
+
+	TestEqual(TEXT("Overlapping requests"),
+		MakeTrace({{EType::Request, 1}, {EType::Request, 2}, {EType::LoadCompleted, 1}, {EType::Request, 3}, {EType::LoadFailed, 2}, {EType::LoadCompleted, 3}}).ComputePeakInFlight(), 2);
+
+	TestEqual(TEXT("Cancels end a request"),
+		MakeTrace({{EType::Request, 1}, {EType::Cancel, 1}, {EType::Request, 2}, {EType::Cancel, 2}, {EType::Request, 3}}).ComputePeakInFlight(), 1);
+
+	TestEqual(TEXT("Dropped requests end a request"),
+		MakeTrace({{EType::Request, 1}, {EType::Dropped, 1}, {EType::Request, 2}, {EType::Dropped, 2}, {EType::Request, 3}}).ComputePeakInFlight(), 1);
+
+	TestEqual(TEXT("Immediate requests, acquisitions and releases are never in flight"),
+		MakeTrace({{EType::ImmediateRequest, 1}, {EType::Acquire, INDEX_NONE}, {EType::Release, INDEX_NONE}}).ComputePeakInFlight(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAsyncWidgetTraceReplayTest, "AsyncWidgetLoader.Trace.Replay",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAsyncWidgetTraceReplayTest::RunTest(const FString& Parameters)
+{
+	// A class that is never loaded, so every replayed request stays in flight until cancelled
+	FAsyncWidgetTrace Trace;
+	Trace.ClassPaths.Add(FSoftObjectPath(TEXT("/Game/AsyncWidgetLoaderTests/WBP_Missing.WBP_Missing_C")));
+
+	auto AddEvent = [&Trace](EAsyncWidgetTraceEventType Type, int32 RequestId)
+	{
+		FAsyncWidgetTraceEvent& Event = Trace.Events.AddDefaulted_GetRef();
+		Event.Type = Type;
+		Event.RequestId = RequestId;
+		Event.ClassIndex = 0;
+	};
+
+	AddEvent(EAsyncWidgetTraceEventType::Request, 10);
+	AddEvent(EAsyncWidgetTraceEventType::Request, 11);
+	AddEvent(EAsyncWidgetTraceEventType::Cancel, 10);
+	AddEvent(EAsyncWidgetTraceEventType::Request, 12);
+	AddEvent(EAsyncWidgetTraceEventType::Dropped, 11);
+	AddEvent(EAsyncWidgetTraceEventType::Request, 13);
+
+	TestEqual(TEXT("Recorded peak"), Trace.ComputePeakInFlight(), 2);
+
+	UAsyncWidgetLoaderSubsystem* Subsystem = NewObject<UAsyncWidgetLoaderSubsystem>(GetTransientPackage());
+	UAsyncWidgetTraceReplayer* Replayer = NewObject<UAsyncWidgetTraceReplayer>(Subsystem);
+	Replayer->StartReplay(Subsystem, MoveTemp(Trace), 0.0f);
+
+	// All events are at time zero, so a single tick dispatches the whole trace
+	Replayer->Tick(0.0f);
+
+	TestEqual(TEXT("Every recorded request was replayed"), Replayer->RecordedToLiveRequestId.Num(), 4);
+	for (const TPair<int32, int32>& Pair : Replayer->RecordedToLiveRequestId)
+	{
+		const int32* RecordedRequestId = Replayer->LiveToRecordedRequestId.Find(Pair.Value);
+		TestTrue(FString::Printf(TEXT("Live request %d maps back to recorded request %d"), Pair.Value, Pair.Key),
+			RecordedRequestId && *RecordedRequestId == Pair.Key);
+	}
+
+	const int32* CancelledRequestId = Replayer->RecordedToLiveRequestId.Find(10);
+	const int32* DroppedRequestId = Replayer->RecordedToLiveRequestId.Find(11);
+	if (TestNotNull(TEXT("Cancelled request replayed"), CancelledRequestId) &&
+		TestNotNull(TEXT("Dropped request replayed"), DroppedRequestId))
+	{
+		TestTrue(TEXT("Recorded cancel cancels the replayed request"),
+			Subsystem->GetRequestStatus(*CancelledRequestId) != EAsyncWidgetLoadStatus::Loading);
+
+		// Drops come from dead requesters, the replayer stays alive so the request keeps loading
+		TestTrue(TEXT("Recorded drop does not cancel the replayed request"),
+			Subsystem->GetRequestStatus(*DroppedRequestId) == EAsyncWidgetLoadStatus::Loading);
+	}
+
+	TestEqual(TEXT("Requests in flight after dispatch"), Subsystem->GetNumActiveRequests(), 3);
+	// The dropped request keeps loading during the replay, so it overlaps with requests 12 and 13
+	TestEqual(TEXT("Replayed peak"), Subsystem->GetStats().PeakInFlightRequests, 3);
+
+	Replayer->StopReplay();
+	TestEqual(TEXT("Stopping the replay cancels its requests"), Subsystem->GetNumActiveRequests(), 0);
+	TestFalse(TEXT("Replay stopped"), Replayer->IsReplaying());
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,187 @@
+﻿// Copyright Mike Desrosiers 2025, All Rights Reserved.
+
+#include "Trace/AsyncWidgetTrace.h"
+
+#include <Blueprint/UserWidget.h>
+#include <HAL/PlatformTime.h>
+#include <Misc/FileHelper.h>
+#include <Serialization/MemoryReader.h>
+#include <Serialization/MemoryWriter.h>
+
+#include "LogAsyncWidgetLoader.h"
+
+namespace AsyncWidgetTrace
+{
+	/** 'AWLT' */
+	static constexpr uint32 Magic = 0x41574C54;
+	static constexpr uint32 Version = 2;
+}
+
+FArchive& operator<<(FArchive& Ar, FAsyncWidgetTraceEvent& Event)
+{
+	uint8 Type = static_cast<uint8>(Event.Type);
+	Ar << Type;
+	Ar << Event.Timestamp;
+	Ar << Event.RequestId;
+	Ar << Event.WidgetId;
+	Ar << Event.ClassIndex;
+	Ar << Event.Priority;
+	Event.Type = static_cast<EAsyncWidgetTraceEventType>(Type);
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FAsyncWidgetTrace& Trace)
+{
+	uint32 Magic = AsyncWidgetTrace::Magic;
+	uint32 Version = AsyncWidgetTrace::Version;
+	Ar << Magic;
+	Ar << Version;
+
+	if (Ar.IsLoading() && (Magic != AsyncWidgetTrace::Magic || Version != AsyncWidgetTrace::Version))
+	{
+		Ar.SetError();
+		return Ar;
+	}
+
+	Ar << Trace.ClassPaths;
+	Ar << Trace.Events;
+	return Ar;
+}
+
+bool FAsyncWidgetTrace::SaveToFile(const FString& FilePath) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	Writer << const_cast<FAsyncWidgetTrace&>(*this);
+
+	if (!FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+	{
+		UE_LOG(LogAsyncWidgetLoader, Error, TEXT("%hs: Failed to write trace to %s"), __FUNCTION__, *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogAsyncWidgetLoader, Log, TEXT("%hs: Wrote %d events (%d bytes) to %s"), __FUNCTION__, Events.Num(), Bytes.Num(), *FilePath);
+	return true;
+}
+
+bool FAsyncWidgetTrace::LoadFromFile(const FString& FilePath)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+	{
+		UE_LOG(LogAsyncWidgetLoader, Error, TEXT("%hs: Failed to read trace from %s"), __FUNCTION__, *FilePath);
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	Reader << *this;
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogAsyncWidgetLoader, Error, TEXT("%hs: %s is not a valid trace file"), __FUNCTION__, *FilePath);
+		Events.Reset();
+		ClassPaths.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+FSoftObjectPath FAsyncWidgetTrace::GetClassPath(const FAsyncWidgetTraceEvent& Event) const
+{
+	return ClassPaths.IsValidIndex(Event.ClassIndex) ? ClassPaths[Event.ClassIndex] : FSoftObjectPath();
+}
+
+int32 FAsyncWidgetTrace::ComputePeakInFlight() const
+{
+	int32 InFlight = 0;
+	int32 Peak = 0;
+	for (const FAsyncWidgetTraceEvent& Event : Events)
+	{
+		switch (Event.Type)
+		{
+		case EAsyncWidgetTraceEventType::Request:
+			Peak = FMath::Max(Peak, ++InFlight);
+			break;
+		case EAsyncWidgetTraceEventType::Cancel:
+		case EAsyncWidgetTraceEventType::LoadCompleted:
+		case EAsyncWidgetTraceEventType::LoadFailed:
+		case EAsyncWidgetTraceEventType::Dropped:
+			InFlight = FMath::Max(0, InFlight - 1);
+			break;
+		default:
+			break;
+		}
+	}
+	return Peak;
+}
+
+void FAsyncWidgetTraceRecorder::Start()
+{
+	Trace.Events.Reset();
+	Trace.ClassPaths.Reset();
+	ClassPathToIndex.Reset();
+	WidgetIds.Reset();
+	NextWidgetId = 0;
+	StartTime = FPlatformTime::Seconds();
+	bRecording = true;
+}
+
+void FAsyncWidgetTraceRecorder::Stop()
+{
+	bRecording = false;
+}
+
+void FAsyncWidgetTraceRecorder::Record(
+	const EAsyncWidgetTraceEventType Type,
+	const int32 RequestId,
+	const FSoftObjectPath& ClassPath,
+	const float Priority,
+	const int32 WidgetId)
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	int32 ClassIndex = INDEX_NONE;
+	if (!ClassPath.IsNull())
+	{
+		if (const int32* ExistingIndex = ClassPathToIndex.Find(ClassPath))
+		{
+			ClassIndex = *ExistingIndex;
+		}
+		else
+		{
+			ClassIndex = Trace.ClassPaths.Add(ClassPath);
+			ClassPathToIndex.Add(ClassPath, ClassIndex);
+		}
+	}
+
+	FAsyncWidgetTraceEvent& Event = Trace.Events.AddDefaulted_GetRef();
+	Event.Timestamp = FPlatformTime::Seconds() - StartTime;
+	Event.RequestId = RequestId;
+	Event.ClassIndex = ClassIndex;
+	Event.WidgetId = WidgetId;
+	Event.Priority = Priority;
+	Event.Type = Type;
+}
+
+int32 FAsyncWidgetTraceRecorder::TrackWidget(const UUserWidget* Widget)
+{
+	if (!bRecording || !Widget)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 WidgetId = NextWidgetId++;
+	WidgetIds.Add(Widget, WidgetId);
+	return WidgetId;
+}
+
+int32 FAsyncWidgetTraceRecorder::UntrackWidget(const UUserWidget* Widget)
+{
+	int32 WidgetId = INDEX_NONE;
+	WidgetIds.RemoveAndCopyValue(Widget, WidgetId);
+	return WidgetId;
+}
@@ -0,0 +1,268 @@
+﻿// Copyright Mike Desrosiers 2025, All Rights Reserved.
+
+#include "Trace/AsyncWidgetTraceReplayer.h"
+
+#include <Blueprint/UserWidget.h>
+#include <Engine/GameInstance.h>
+#include <Engine/World.h>
+#include <HAL/IConsoleManager.h>
+
+#include "AsyncWidgetLoaderSubsystem.h"
+#include "LogAsyncWidgetLoader.h"
+
+namespace AsyncWidgetTraceReplayer
+{
+	static UAsyncWidgetLoaderSubsystem* FindSubsystem(const UWorld* World)
+	{
+		const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		return GameInstance ? GameInstance->GetSubsystem<UAsyncWidgetLoaderSubsystem>() : nullptr;
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs StartRecordingCommand(
+		TEXT("AsyncWidgetLoader.Trace.Start"),
+		TEXT("Start recording async widget loader traffic"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UAsyncWidgetLoaderSubsystem* Subsystem = FindSubsystem(World))
+			{
+				Subsystem->StartTraceRecording();
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs StopRecordingCommand(
+		TEXT("AsyncWidgetLoader.Trace.Stop"),
+		TEXT("Stop recording async widget loader traffic and save it. Usage: AsyncWidgetLoader.Trace.Stop [FilePath]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UAsyncWidgetLoaderSubsystem* Subsystem = FindSubsystem(World))
+			{
+				Subsystem->StopTraceRecording(Args.IsValidIndex(0) ? Args[0] : TEXT("AsyncWidgetLoader.trace"));
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs ReplayCommand(
+		TEXT("AsyncWidgetLoader.Trace.Replay"),
+		TEXT("Replay a recorded trace and report frame time, pool hits and in-flight peaks. Usage: AsyncWidgetLoader.Trace.Replay [FilePath] [SyntheticLoadDelay]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UAsyncWidgetLoaderSubsystem* Subsystem = FindSubsystem(World))
+			{
+				const FString FilePath = Args.IsValidIndex(0) ? Args[0] : TEXT("AsyncWidgetLoader.trace");
+				const float Delay = Args.IsValidIndex(1) ? FCString::Atof(*Args[1]) : 0.1f;
+				Subsystem->ReplayTrace(FilePath, Delay);
+			}
+		}));
+}
+
+void UAsyncWidgetTraceReplayer::StartReplay(
+	UAsyncWidgetLoaderSubsystem* InSubsystem,
+	FAsyncWidgetTrace&& InTrace,
+	const float SyntheticLoadDelay)
+{
+	check(InSubsystem);
+
+	StopReplay();
+
+	Subsystem = InSubsystem;
+	Trace = MoveTemp(InTrace);
+	NextEventIndex = 0;
+	ElapsedTime = 0.0;
+	NumFrames = 0;
+	NumSpikes = 0;
+	TotalFrameTimeMs = 0.0f;
+	WorstFrameTimeMs = 0.0f;
+
+	for (const FAsyncWidgetTraceEvent& Event : Trace.Events)
+	{
+		if ((Event.Type == EAsyncWidgetTraceEventType::ImmediateRequest || Event.Type == EAsyncWidgetTraceEventType::LoadCompleted) &&
+			Event.WidgetId != INDEX_NONE)
+		{
+			RecordedRequestWidgetIds.Add(Event.RequestId, Event.WidgetId);
+		}
+	}
+
+	InSubsystem->ResetStats();
+	InSubsystem->SetSyntheticLoadDelay(SyntheticLoadDelay);
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::Tick));
+
+	UE_LOG(LogAsyncWidgetLoader, Log, TEXT("%hs: Replaying %d events with a synthetic load delay of %.3fs"), __FUNCTION__, Trace.Events.Num(), SyntheticLoadDelay);
+}
+
+void UAsyncWidgetTraceReplayer::StopReplay()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	if (Subsystem.IsValid())
+	{
+		for (const TPair<int32, int32>& Pair : RecordedToLiveRequestId)
+		{
+			if (Subsystem->GetRequestStatus(Pair.Value) == EAsyncWidgetLoadStatus::Loading)
+			{
+				Subsystem->CancelRequest(Pair.Value);
+			}
+		}
+		Subsystem->SetSyntheticLoadDelay(0.0f);
+
+		// Hand back everything the trace never released so the pools are left as we found them
+		for (const TPair<int32, TObjectPtr<UUserWidget>>& Pair : HeldWidgets)
+		{
+			if (Pair.Value)
+			{
+				Subsystem->ReleaseWidgetToPool(Pair.Value);
+			}
+		}
+		for (UUserWidget* Widget : UnreleasedWidgets)
+		{
+			if (Widget)
+			{
+				Subsystem->ReleaseWidgetToPool(Widget);
+			}
+		}
+	}
+
+	RecordedToLiveRequestId.Reset();
+	LiveToRecordedRequestId.Reset();
+	RecordedRequestWidgetIds.Reset();
+	HeldWidgets.Reset();
+	UnreleasedWidgets.Reset();
+}
+
+void UAsyncWidgetTraceReplayer::OnAsyncWidgetLoaded_Implementation(int32 RequestId, UUserWidget* LoadedWidget)
+{
+	const int32* RecordedRequestId = LiveToRecordedRequestId.Find(RequestId);
+	const int32* RecordedWidgetId = RecordedRequestId ? RecordedRequestWidgetIds.Find(*RecordedRequestId) : nullptr;
+	HoldWidget(RecordedWidgetId ? *RecordedWidgetId : INDEX_NONE, LoadedWidget);
+}
+
+void UAsyncWidgetTraceReplayer::HoldWidget(const int32 RecordedWidgetId, UUserWidget* Widget)
+{
+	if (!Widget)
+	{
+		return;
+	}
+
+	// Widgets with no recorded ID, or whose ID is already taken, are never released by the trace
+	if (RecordedWidgetId == INDEX_NONE || HeldWidgets.Contains(RecordedWidgetId))
+	{
+		UnreleasedWidgets.Add(Widget);
+		return;
+	}
+
+	HeldWidgets.Add(RecordedWidgetId, Widget);
+}
+
+bool UAsyncWidgetTraceReplayer::Tick(const float DeltaTime)
+{
+	if (!Subsystem.IsValid())
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+
+	// The first tick only marks the start of the replay, it has no meaningful frame time
+	if (ElapsedTime > 0.0)
+	{
+		const float FrameTimeMs = DeltaTime * 1000.0f;
+		++NumFrames;
+		TotalFrameTimeMs += FrameTimeMs;
+		WorstFrameTimeMs = FMath::Max(WorstFrameTimeMs, FrameTimeMs);
+		if (FrameTimeMs > SpikeThresholdMs)
+		{
+			++NumSpikes;
+		}
+	}
+	ElapsedTime += DeltaTime;
+
+	while (Trace.Events.IsValidIndex(NextEventIndex) && Trace.Events[NextEventIndex].Timestamp <= ElapsedTime)
+	{
+		DispatchEvent(Trace.Events[NextEventIndex++]);
+	}
+
+	if (NextEventIndex >= Trace.Events.Num() && Subsystem->GetNumActiveRequests() == 0)
+	{
+		FinishReplay();
+		return false;
+	}
+
+	return true;
+}
+
+void UAsyncWidgetTraceReplayer::DispatchEvent(const FAsyncWidgetTraceEvent& Event)
+{
+	const FSoftObjectPath ClassPath = Trace.GetClassPath(Event);
+
+	switch (Event.Type)
+	{
+	case EAsyncWidgetTraceEventType::Request:
+	case EAsyncWidgetTraceEventType::ImmediateRequest:
+		{
+			int32 LiveRequestId = INDEX_NONE;
+			UUserWidget* Widget = Subsystem->RequestWidget_Async(
+				TSoftClassPtr<UUserWidget>(ClassPath),
+				this,
+				LiveRequestId,
+				FOnAsyncWidgetLoadedDynamic(),
+				Event.Priority);
+
+			RecordedToLiveRequestId.Add(Event.RequestId, LiveRequestId);
+			LiveToRecordedRequestId.Add(LiveRequestId, Event.RequestId);
+			if (Widget)
+			{
+				const int32* RecordedWidgetId = RecordedRequestWidgetIds.Find(Event.RequestId);
+				HoldWidget(RecordedWidgetId ? *RecordedWidgetId : INDEX_NONE, Widget);
+			}
+			break;
+		}
+	case EAsyncWidgetTraceEventType::Acquire:
+		{
+			// Acquisitions are synchronous, so the class is loaded synchronously as well
+			const TSubclassOf<UUserWidget> WidgetClass = TSoftClassPtr<UUserWidget>(ClassPath).LoadSynchronous();
+			HoldWidget(Event.WidgetId, Subsystem->GetOrCreatePooledWidget(WidgetClass));
+			break;
+		}
+	case EAsyncWidgetTraceEventType::Cancel:
+		{
+			if (const int32* LiveRequestId = RecordedToLiveRequestId.Find(Event.RequestId))
+			{
+				Subsystem->CancelRequest(*LiveRequestId);
+			}
+			break;
+		}
+	case EAsyncWidgetTraceEventType::Release:
+		{
+			// Hand back the widget produced by the same recorded request or acquisition, if the replay got one
+			TObjectPtr<UUserWidget> Widget;
+			if (Event.WidgetId != INDEX_NONE && HeldWidgets.RemoveAndCopyValue(Event.WidgetId, Widget) && Widget)
+			{
+				Subsystem->ReleaseWidgetToPool(Widget);
+			}
+			break;
+		}
+	case EAsyncWidgetTraceEventType::LoadCompleted:
+	case EAsyncWidgetTraceEventType::LoadFailed:
+	case EAsyncWidgetTraceEventType::Dropped:
+		// Completions are driven by the synthetic load delay, the recorded ones are only used for the report
+		break;
+	}
+}
+
+void UAsyncWidgetTraceReplayer::FinishReplay()
+{
+	const FAsyncWidgetLoaderStats Stats = Subsystem->GetStats();
+	const float AverageFrameTimeMs = NumFrames > 0 ? TotalFrameTimeMs / NumFrames : 0.0f;
+
+	UE_LOG(LogAsyncWidgetLoader, Display, TEXT("Async widget trace replay finished after %.2fs (%d events)"), ElapsedTime, Trace.Events.Num());
+	UE_LOG(LogAsyncWidgetLoader, Display, TEXT("  Frames: %d, average %.2fms, worst %.2fms, %d spikes over %.1fms"),
+		NumFrames, AverageFrameTimeMs, WorstFrameTimeMs, NumSpikes, SpikeThresholdMs);
+	UE_LOG(LogAsyncWidgetLoader, Display, TEXT("  Pool: %d hits, %d misses, %.1f%% hit rate"),
+		Stats.PoolHits, Stats.PoolMisses, Stats.GetPoolHitRate() * 100.0f);
+	UE_LOG(LogAsyncWidgetLoader, Display, TEXT("  Peak in-flight requests: %d replayed, %d recorded"),
+		Stats.PeakInFlightRequests, Trace.ComputePeakInFlight());
+
+	StopReplay();
+}
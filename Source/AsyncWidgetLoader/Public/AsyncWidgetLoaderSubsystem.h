@@ -1,14 +1,18 @@
 ﻿#pragma once
 
 #include <CoreMinimal.h>
+#include <Containers/Ticker.h>
 #include <Subsystems/GameInstanceSubsystem.h>
 #include <Engine/StreamableManager.h>
 #include <Blueprint/UserWidget.h>
 #include <Blueprint/UserWidgetPool.h>
 
 #include "AsyncWidgetLoaderTypes.h"
+#include "Trace/AsyncWidgetTrace.h"
 #include "AsyncWidgetLoaderSubsystem.generated.h"
 
+class FAsyncWidgetRequestGroup;
+class UAsyncWidgetTraceReplayer;
 
 /**
  * A subsystem that manages asynchronous loading of widgets and pooling
@@ -18,12 +22,17 @@
  * - Widget pooling to avoid constant recreation
  * - Placeholder widgets during loading
  * - Handles for easy lifetime management
+ * - Bulk cancellation per requester (see also FAsyncWidgetRequestGroup)
+ * - Opt-in travel-persistent classes and pools that survive map transitions
  */
 UCLASS(BlueprintType, DisplayName = "Async Widget Loader")
 class ASYNCWIDGETLOADER_API UAsyncWidgetLoaderSubsystem : public UGameInstanceSubsystem
 {
 	GENERATED_BODY()
 
+	friend class FAsyncWidgetRequestGroup;
+	friend class FAsyncWidgetRequesterIndexTest;
+
 public:
 	UAsyncWidgetLoaderSubsystem();
 
@@ -70,6 +79,21 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Async Widget Loader")
 	void SetWidgetCreationContext(UWorld* World, APlayerController* PlayerController);
 
+	/**
+	 * Flag a widget class as travel-persistent
+	 * Persistent classes stay loaded across map transitions, and their inactive pooled instances are
+	 * re-parented to the new world and player controller instead of being destroyed
+	 * 
+	 * @param WidgetClass The widget class to flag
+	 * @param bPersistent Whether the class should survive map travel
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Async Widget Loader")
+	void SetWidgetClassTravelPersistent(const TSoftClassPtr<UUserWidget>& WidgetClass, bool bPersistent);
+
+	/** Check if a widget class is flagged as travel-persistent */
+	UFUNCTION(BlueprintPure, Category = "Async Widget Loader")
+	bool IsWidgetClassTravelPersistent(const TSoftClassPtr<UUserWidget>& WidgetClass) const;
+
 	/**
 	 * Release all widgets in all pools
 	 */
@@ -86,6 +110,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Async Widget Loader")
 	UUserWidget* GetOrCreatePooledWidget(const TSubclassOf<UUserWidget>& LoadedWidgetClass);
 
+	/**
+	 * Return a widget to its pool
+	 * Also cancels the widget's own pending requests and those of any request groups it owns,
+	 * since released widgets are removed from their parent without being destructed
+	 * 
+	 * @param Widget The widget to release
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Async Widget Loader")
 	void ReleaseWidgetToPool(UUserWidget* Widget);
 
@@ -98,6 +129,24 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Async Widget Loader")
 	bool CancelRequest(int32 RequestId);
 
+	/**
+	 * Cancel every in-progress request made by a requester, e.g. when a screen is torn down
+	 * 
+	 * @param Requester The object that made the requests
+	 * @return The number of requests cancelled
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Async Widget Loader")
+	int32 CancelAllForRequester(UObject* Requester);
+
+	/**
+	 * Cancel every in-progress request made by a widget or by request groups it owns
+	 * Call this when tearing down a widget that was not created through the pool
+	 * 
+	 * @param Widget The widget being torn down
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Async Widget Loader")
+	void CancelRequestsOwnedByWidget(UUserWidget* Widget);
+
 	/**
 	 * Get the status of an async widget request
 	 * 
@@ -109,6 +158,55 @@ public:
 
 	/** Remove completed or cancelled requests */
 	void CleanupRequests();
+
+	/**
+	 * Start recording a trace of requests, cancels, releases and load completions
+	 * Any previously recorded trace is discarded
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Async Widget Loader|Trace")
+	void StartTraceRecording();
+
+	/**
+	 * Stop recording and write the trace to disk
+	 * 
+	 * @param FilePath Where to write the trace (relative paths are resolved against the project saved dir)
+	 * @return True if the trace was written
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Async Widget Loader|Trace")
+	bool StopTraceRecording(const FString& FilePath);
+
+	/** Is a trace currently being recorded */
+	UFUNCTION(BlueprintPure, Category = "Async Widget Loader|Trace")
+	bool IsTraceRecording() const { return TraceRecorder.IsRecording(); }
+
+	/**
+	 * Replay a recorded trace against this subsystem and log frame time, pool and in-flight statistics when done
+	 * 
+	 * @param FilePath The trace to replay (relative paths are resolved against the project saved dir)
+	 * @param SyntheticLoadDelay Seconds to hold back every async load completion during the replay
+	 * @return True if the replay was started
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Async Widget Loader|Trace")
+	bool ReplayTrace(const FString& FilePath, float SyntheticLoadDelay = 0.1f);
+
+	/**
+	 * Delay every async load completion by a fixed amount, used to simulate slow IO
+	 * 
+	 * @param Seconds The delay to apply, 0 to disable
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Async Widget Loader|Trace")
+	void SetSyntheticLoadDelay(float Seconds) { SyntheticLoadDelay = FMath::Max(0.0f, Seconds); }
+
+	/** Get the pool and in-flight counters gathered since the last reset */
+	UFUNCTION(BlueprintPure, Category = "Async Widget Loader")
+	FAsyncWidgetLoaderStats GetStats() const { return Stats; }
+
+	/** Reset the pool and in-flight counters */
+	UFUNCTION(BlueprintCallable, Category = "Async Widget Loader")
+	void ResetStats();
+
+	/** Number of async requests currently in flight */
+	int32 GetNumActiveRequests() const { return ActiveRequests.Num(); }
 protected:
 	/** StreamableManager for handling async loading */
 	FStreamableManager StreamableManager;
@@ -121,6 +219,12 @@ protected:
 	UPROPERTY()
 	TMap<int32, FAsyncWidgetRequest> ActiveRequests;
 
+	/** Secondary index of requesters to their active request IDs */
+	TMap<TObjectKey<UObject>, TArray<int32>> RequesterToRequestIds;
+
+	/** Request groups owned by each widget, cancelled when the widget is released to its pool */
+	TMap<TObjectKey<UUserWidget>, TArray<FAsyncWidgetRequestGroup*>> WidgetToRequestGroups;
+
 	/** Default world for widget creation */
 	UPROPERTY()
 	TWeakObjectPtr<UWorld> DefaultWorld;
@@ -135,6 +239,13 @@ protected:
 	
 	/** Process when a widget class finishes loading */
 	void OnWidgetClassLoaded(int32 RequestId);
+
+	/** Remove a request from the active requests and the requester index */
+	void RemoveRequest(int32 RequestId);
+
+	/** Track a request group so it is cancelled when its owning widget is released */
+	void RegisterRequestGroup(UUserWidget* OwningWidget, FAsyncWidgetRequestGroup* Group);
+	void UnregisterRequestGroup(const TObjectKey<UUserWidget>& OwningWidget, FAsyncWidgetRequestGroup* Group);
 	
 
 	UPROPERTY()
@@ -142,6 +253,56 @@ protected:
 
 	FTimerHandle CleanupTimerHandle;
 
+	/** Get a widget from its class pool without tracing it as a synchronous acquisition */
+	UUserWidget* AcquirePooledWidget(const TSubclassOf<UUserWidget>& LoadedWidgetClass);
+
 	/** Get a pool for the specified class path */
 	FUserWidgetPool& GetOrCreatePool(const TSoftClassPtr<UUserWidget>& ClassPath);
+
+	/** Drop non-persistent pools and move persistent pooled widgets out of a world that is going away */
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	/** Point pools and persistent pooled widgets at the newly loaded world */
+	void OnPostLoadMapWithWorld(UWorld* World);
+
+	/**
+	 * Point pools and all persistent pooled widgets at the world's local player controller
+	 * @return False if the controller or its local player does not exist yet
+	 */
+	bool TryApplyTravelContext(UWorld* World);
+
+	/** Stop waiting for a local player controller after travel, if we are */
+	void StopWaitingForPlayerController();
+
+	/** Get all widgets of a pool that are known to us, active or inactive */
+	void GetKnownPooledWidgets(const FString& PoolKey, TArray<UUserWidget*>& OutWidgets) const;
+
+	/** Class paths flagged as travel-persistent, mapped to the loaded class once known so it stays referenced */
+	UPROPERTY()
+	TMap<FString, TObjectPtr<UClass>> TravelPersistentClasses;
+
+	FDelegateHandle WorldCleanupHandle;
+	FDelegateHandle PostLoadMapHandle;
+
+	/** World we are waiting on for a local player controller with a local player attached */
+	TWeakObjectPtr<UWorld> PlayerControllerWaitWorld;
+
+	FTSTicker::FDelegateHandle PlayerControllerWaitHandle;
+
+	/** Pool and in-flight counters */
+	UPROPERTY()
+	FAsyncWidgetLoaderStats Stats;
+
+	/** Widgets that have been handed out by a pool at least once, used to tell pool hits from misses */
+	TSet<TObjectKey<UUserWidget>> KnownPooledWidgets;
+
+	/** Records traffic while a trace is being captured */
+	FAsyncWidgetTraceRecorder TraceRecorder;
+
+	/** Replay currently driving this subsystem, if any */
+	UPROPERTY()
+	TObjectPtr<UAsyncWidgetTraceReplayer> TraceReplayer;
+
+	/** Seconds to hold back async load completions (for replays) */
+	float SyntheticLoadDelay = 0.0f;
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include <CoreMinimal.h>
 #include <Blueprint/UserWidget.h>
+#include <UObject/ObjectKey.h>
 
 #include "Engine/StreamableManager.h"
 
@@ -22,6 +23,32 @@ enum class EAsyncWidgetLoadStatus : uint8
 	Cancelled
 };
 
+// Counters describing how the subsystem has been serving requests
+USTRUCT(BlueprintType)
+struct ASYNCWIDGETLOADER_API FAsyncWidgetLoaderStats
+{
+	GENERATED_BODY()
+
+	/** Widgets handed out by reusing an inactive pooled instance */
+	UPROPERTY(BlueprintReadOnly, Category = "Async Widget Loader")
+	int32 PoolHits = 0;
+
+	/** Widgets handed out by constructing a new instance */
+	UPROPERTY(BlueprintReadOnly, Category = "Async Widget Loader")
+	int32 PoolMisses = 0;
+
+	/** Highest number of async requests that were in flight at once */
+	UPROPERTY(BlueprintReadOnly, Category = "Async Widget Loader")
+	int32 PeakInFlightRequests = 0;
+
+	/** Fraction of widgets served from the pool */
+	float GetPoolHitRate() const
+	{
+		const int32 Total = PoolHits + PoolMisses;
+		return Total > 0 ? static_cast<float>(PoolHits) / Total : 0.0f;
+	}
+};
+
 // Tracks a single widget load request
 USTRUCT()
 struct ASYNCWIDGETLOADER_API FAsyncWidgetRequest
@@ -40,6 +67,9 @@ struct ASYNCWIDGETLOADER_API FAsyncWidgetRequest
 	/** The object that requested the widget */
 	TWeakObjectPtr<UObject> Requester;
 
+	/** Key of the requester in the subsystem's requester index, stays unique after the requester dies */
+	TObjectKey<UObject> RequesterKey;
+
 	/** Strong reference to the streamable handle */
 	TSharedPtr<FStreamableHandle> StreamableHandle;
 
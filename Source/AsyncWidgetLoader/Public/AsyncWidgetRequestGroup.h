@@ -0,0 +1,63 @@
+﻿// Copyright Mike Desrosiers 2025, All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <UObject/ObjectKey.h>
+
+class UAsyncWidgetLoaderSubsystem;
+class UUserWidget;
+
+/**
+ * Scoped group of async widget requests that are cancelled together
+ *
+ * All requests added to the group are cancelled when the group is destroyed, or when the
+ * optional owning widget goes away:
+ * - Released through UAsyncWidgetLoaderSubsystem::ReleaseWidgetToPool (pooled widgets keep their
+ *   Slate widget when removed from their parent, so they are never destructed)
+ * - Destructed, for widgets created outside the pool
+ * Widgets torn down any other way should call UAsyncWidgetLoaderSubsystem::CancelRequestsOwnedByWidget.
+ * Not copyable or movable, hold it by value in the owning object or in a TUniquePtr.
+ */
+class ASYNCWIDGETLOADER_API FAsyncWidgetRequestGroup
+{
+public:
+	/**
+	 * @param InSubsystem The subsystem the requests were made through
+	 * @param InOwningWidget Optional widget whose release to the pool or destruction cancels the group
+	 */
+	explicit FAsyncWidgetRequestGroup(UAsyncWidgetLoaderSubsystem* InSubsystem, UUserWidget* InOwningWidget = nullptr);
+	~FAsyncWidgetRequestGroup();
+
+	UE_NONCOPYABLE(FAsyncWidgetRequestGroup);
+
+	/** Add a request to the group */
+	void Add(int32 RequestId);
+
+	/**
+	 * Cancel all requests in the group that are still in progress
+	 *
+	 * @return The number of requests cancelled
+	 */
+	int32 CancelAll();
+
+	/** Number of requests tracked by the group */
+	int32 Num() const { return RequestIds.Num(); }
+
+private:
+	/** Drop requests that are no longer in progress */
+	void PruneFinishedRequests();
+
+	void OnOwningWidgetDestructed(UUserWidget* Widget);
+
+	TWeakObjectPtr<UAsyncWidgetLoaderSubsystem> Subsystem;
+
+	TWeakObjectPtr<UUserWidget> OwningWidget;
+
+	/** Key the group is registered under with the subsystem, valid even after the widget dies */
+	TObjectKey<UUserWidget> OwningWidgetKey;
+
+	FDelegateHandle OwningWidgetDestructHandle;
+
+	TArray<int32> RequestIds;
+};
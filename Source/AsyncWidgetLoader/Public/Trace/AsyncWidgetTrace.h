@@ -0,0 +1,131 @@
+﻿// Copyright Mike Desrosiers 2025, All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <UObject/ObjectKey.h>
+#include <UObject/SoftObjectPath.h>
+
+class UUserWidget;
+
+// Kind of event captured in an async widget trace
+enum class EAsyncWidgetTraceEventType : uint8
+{
+	/** RequestWidget_Async was called */
+	Request,
+	/** RequestWidget_Async was served immediately because the class was already loaded */
+	ImmediateRequest,
+	/** CancelRequest was called */
+	Cancel,
+	/** ReleaseWidgetToPool was called */
+	Release,
+	/** An async class load finished and a widget was handed to the requester */
+	LoadCompleted,
+	/** An async class load finished but no widget could be produced */
+	LoadFailed,
+	/** A request was dropped without notifying its requester (requester no longer valid) */
+	Dropped,
+	/** A widget was taken from a pool synchronously through RequestWidget or GetOrCreatePooledWidget */
+	Acquire
+};
+
+// A single entry of an async widget trace
+struct ASYNCWIDGETLOADER_API FAsyncWidgetTraceEvent
+{
+	/** Seconds since the recording started */
+	double Timestamp = 0.0;
+
+	/** Request the event belongs to (INDEX_NONE for acquisitions and releases) */
+	int32 RequestId = INDEX_NONE;
+
+	/**
+	 * Trace-local ID of the widget handed out (ImmediateRequest, LoadCompleted, Acquire) or returned (Release)
+	 * INDEX_NONE for releases of widgets obtained before the recording started
+	 */
+	int32 WidgetId = INDEX_NONE;
+
+	/** Index into the trace's class path table */
+	int32 ClassIndex = INDEX_NONE;
+
+	/** Priority the request was made with */
+	float Priority = 0.0f;
+
+	/** What happened */
+	EAsyncWidgetTraceEventType Type = EAsyncWidgetTraceEventType::Request;
+
+	friend FArchive& operator<<(FArchive& Ar, FAsyncWidgetTraceEvent& Event);
+};
+
+/**
+ * A compact binary recording of the traffic seen by UAsyncWidgetLoaderSubsystem
+ *
+ * Class paths are stored once in a table and referenced by index from each event,
+ * so a trace costs roughly 20 bytes per event.
+ */
+class ASYNCWIDGETLOADER_API FAsyncWidgetTrace
+{
+public:
+	/** Recorded events, in order */
+	TArray<FAsyncWidgetTraceEvent> Events;
+
+	/** Unique class paths referenced by the events */
+	TArray<FSoftObjectPath> ClassPaths;
+
+	/** Save the trace to disk */
+	bool SaveToFile(const FString& FilePath) const;
+
+	/** Load a trace from disk, replacing the current contents */
+	bool LoadFromFile(const FString& FilePath);
+
+	/** Get the class path for an event (null path if the event has none) */
+	FSoftObjectPath GetClassPath(const FAsyncWidgetTraceEvent& Event) const;
+
+	/** Highest number of async requests that were in flight at once while recording */
+	int32 ComputePeakInFlight() const;
+
+	friend FArchive& operator<<(FArchive& Ar, FAsyncWidgetTrace& Trace);
+};
+
+/**
+ * Records events into an FAsyncWidgetTrace while active
+ */
+class ASYNCWIDGETLOADER_API FAsyncWidgetTraceRecorder
+{
+public:
+	/** Start a new recording, discarding any previous one */
+	void Start();
+
+	/** Stop recording, keeping the captured trace */
+	void Stop();
+
+	/** Is a recording in progress */
+	bool IsRecording() const { return bRecording; }
+
+	/** Append an event to the trace if recording */
+	void Record(EAsyncWidgetTraceEventType Type, int32 RequestId, const FSoftObjectPath& ClassPath, float Priority = 0.0f, int32 WidgetId = INDEX_NONE);
+
+	/** Assign a trace-local ID to a widget being handed out (INDEX_NONE if not recording) */
+	int32 TrackWidget(const UUserWidget* Widget);
+
+	/** Forget a widget being released and return its trace-local ID (INDEX_NONE if unknown) */
+	int32 UntrackWidget(const UUserWidget* Widget);
+
+	/** Get the captured trace */
+	const FAsyncWidgetTrace& GetTrace() const { return Trace; }
+
+private:
+	FAsyncWidgetTrace Trace;
+
+	/** Class path to index in Trace.ClassPaths */
+	TMap<FSoftObjectPath, int32> ClassPathToIndex;
+
+	/** Widgets currently handed out, to their trace-local ID */
+	TMap<TObjectKey<UUserWidget>, int32> WidgetIds;
+
+	int32 NextWidgetId = 0;
+
+	/** Platform time the recording started at */
+	double StartTime = 0.0;
+
+	bool bRecording = false;
+};
@@ -0,0 +1,104 @@
+﻿// Copyright Mike Desrosiers 2025, All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Containers/Ticker.h>
+#include <UObject/Object.h>
+
+#include "Interfaces/IAsyncWidgetRequestHandler.h"
+#include "Trace/AsyncWidgetTrace.h"
+
+#include "AsyncWidgetTraceReplayer.generated.h"
+
+class UAsyncWidgetLoaderSubsystem;
+
+/**
+ * Feeds a recorded FAsyncWidgetTrace back into a UAsyncWidgetLoaderSubsystem at its original pace
+ *
+ * Acts as the requester for every replayed request and holds on to the widgets it receives, so that
+ * each recorded release returns the widget produced by the same recorded request or acquisition.
+ * Logs a report once the trace is exhausted and all replayed loads have settled:
+ * - Frame time average, worst frame and number of spikes
+ * - Pool hit rate
+ * - Peak in-flight requests, recorded vs replayed
+ */
+UCLASS()
+class ASYNCWIDGETLOADER_API UAsyncWidgetTraceReplayer : public UObject, public IAsyncWidgetRequestHandler
+{
+	GENERATED_BODY()
+
+	friend class FAsyncWidgetTraceReplayTest;
+
+public:
+	/**
+	 * Start replaying a trace
+	 *
+	 * @param InSubsystem The subsystem to drive
+	 * @param InTrace The trace to replay
+	 * @param SyntheticLoadDelay Seconds to hold back every async load completion
+	 */
+	void StartReplay(UAsyncWidgetLoaderSubsystem* InSubsystem, FAsyncWidgetTrace&& InTrace, float SyntheticLoadDelay);
+
+	/** Abort the replay without reporting */
+	void StopReplay();
+
+	/** Is a replay in progress */
+	bool IsReplaying() const { return TickerHandle.IsValid(); }
+
+	/** Frames longer than this (in milliseconds) are counted as spikes */
+	float SpikeThresholdMs = 33.3f;
+
+	//~ Begin IAsyncWidgetRequestHandler Interface
+	virtual void OnAsyncWidgetLoaded_Implementation(int32 RequestId, UUserWidget* LoadedWidget) override;
+	//~ End IAsyncWidgetRequestHandler Interface
+
+protected:
+	/** Dispatch due events and sample the frame time */
+	bool Tick(float DeltaTime);
+
+	/** Replay a single recorded event */
+	void DispatchEvent(const FAsyncWidgetTraceEvent& Event);
+
+	/** Log the results and stop */
+	void FinishReplay();
+
+	/** Keep a widget produced by a replayed request or acquisition until the matching release */
+	void HoldWidget(int32 RecordedWidgetId, UUserWidget* Widget);
+
+	UPROPERTY()
+	TWeakObjectPtr<UAsyncWidgetLoaderSubsystem> Subsystem;
+
+	/** Widgets handed to us that have not been released yet, by the trace-local widget ID they were recorded with */
+	UPROPERTY()
+	TMap<int32, TObjectPtr<UUserWidget>> HeldWidgets;
+
+	/** Widgets handed to us that the trace never releases, returned to their pools when the replay stops */
+	UPROPERTY()
+	TArray<TObjectPtr<UUserWidget>> UnreleasedWidgets;
+
+	FAsyncWidgetTrace Trace;
+
+	/** Recorded request ID to the ID of its replayed counterpart */
+	TMap<int32, int32> RecordedToLiveRequestId;
+
+	/** Replayed request ID back to the recorded one */
+	TMap<int32, int32> LiveToRecordedRequestId;
+
+	/** Recorded request ID to the trace-local ID of the widget it produced */
+	TMap<int32, int32> RecordedRequestWidgetIds;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	/** Index of the next event to dispatch */
+	int32 NextEventIndex = 0;
+
+	/** Seconds since the replay started */
+	double ElapsedTime = 0.0;
+
+	/** Frame time samples */
+	int32 NumFrames = 0;
+	int32 NumSpikes = 0;
+	float TotalFrameTimeMs = 0.0f;
+	float WorstFrameTimeMs = 0.0f;
+};